@@ -57,6 +57,13 @@ uint32_t BitStream_read(BitStream* stream, int num_bits) {
     return result;
 }
 
+uint32_t BitStream_peek(BitStream* stream, int num_bits) {
+    int position = stream->position;
+    uint32_t result = BitStream_read(stream, num_bits);
+    stream->position = position;
+    return result;
+}
+
 void BitStream_read_str(BitStream* stream, char* buf, int buf_len) {
     int i;
     for (i = 0; i < buf_len; i++) {
@@ -103,7 +110,7 @@ void BitStream_print(BitStream* stream) {
     printf("\n");
 }
 
-void EncodedChar_init(EncodedChar* ec, char symbol, int length, int encoding) {
+void EncodedChar_init(EncodedChar* ec, uint16_t symbol, int length, int encoding) {
     ec->raw_symbol = symbol;
     ec->encoded_len = length;
     ec->encoded_symbol = encoding;
@@ -4,7 +4,7 @@
 #include "string.h"
 
 struct EncodedChar {
-    char raw_symbol;
+    uint16_t raw_symbol;
     int encoded_len;
     int encoded_symbol;
 };
@@ -23,11 +23,12 @@ void BitStream_write(BitStream* stream, uint32_t data, int num_bits);
 void BitStream_write_str(BitStream* stream, char* str);
 void BitStream_write_chars(BitStream* stream, char* chars, int num_chars);
 uint32_t BitStream_read(BitStream* stream, int num_bits);
+uint32_t BitStream_peek(BitStream* stream, int num_bits);
 void BitStream_read_str(BitStream* stream, char* buf, int buf_len);
 void BitStream_read_chars(BitStream* stream, char* buf, int num_chars);
 void BitStream_save(BitStream* stream, char* filepath);
 void BitStream_load(BitStream* stream, char* filepath);
 void BitStream_print(BitStream* stream);
-void EncodedChar_init(EncodedChar* ec, char symbol, int length, int encoding);
+void EncodedChar_init(EncodedChar* ec, uint16_t symbol, int length, int encoding);
 void EncodedChar_push_bit(EncodedChar* ec, int bit);
 int EncodedChar_pop_bit(EncodedChar* ec);
\ No newline at end of file
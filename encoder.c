@@ -340,11 +340,118 @@ void encode_file(char* filepath, int encode_levels) {
 
 }
 
+void encode_file_wide(char* filepath, int use_delta) {
+
+    char* fname = filepath;
+    uint32_t i = 1;
+    while (filepath[i]) {
+        if (filepath[i - 1] == '/' || filepath[i - 1] == '\\')
+        fname = filepath + i;
+        i++;
+    }
+
+    BitStream in_stream;
+    BitStream_init_empty(&in_stream, 1048576);
+    BitStream_load(&in_stream, filepath);
+
+    FILE* f = fopen(filepath, "rb");
+    fseek(f, 0L, SEEK_END);
+    uint32_t num_bytes = ftell(f);
+    fclose(f);
+
+    if (num_bytes > 1000000) {
+        printf("The file cannot be encoded because it exceeds 1MB in size.\n");
+        exit(0);
+    }
+
+    // Split the file into little-endian 16-bit samples, optionally replacing each with its difference from the last
+    int num_samples = num_bytes / 2 + num_bytes % 2;
+    uint16_t* samples = malloc((num_samples ? num_samples : 1) * sizeof(uint16_t));
+    WideSamples_load(samples, in_stream.data, num_bytes);
+    if (use_delta) {
+        WideSamples_delta(samples, num_samples);
+    }
+
+    // Build a sparse histogram and a canonical, length-limited code over the used symbols only
+    int max_symbols = num_samples < 65536 ? num_samples : 65536;
+    WideSymbol* symbols = malloc((max_symbols ? max_symbols : 1) * sizeof(WideSymbol));
+    int num_used = WideSymbol_histogram(symbols, samples, num_samples);
+    WideSymbol_build_lengths(symbols, num_used);
+    WideSymbol_assign_codes(symbols, num_used);
+
+    // Initialize the bitstream with the file identifier and the encoded file's name
+    // Worst case output is 20 bits per sample plus the table, so this needs more room than the byte mode
+    BitStream* stream = malloc(sizeof(BitStream));
+    BitStream_init_empty(stream, 2097152);
+    BitStream_write_chars(stream, "HENC2\0", 6);
+    BitStream_write_str(stream, fname);
+
+    // Append the number of bytes in the original file and the mode flags to the bitstream
+    for (i = 0; i < 4; i++) {
+        BitStream_write(stream, ((uint8_t*)(&num_bytes))[i], 8);
+    }
+    BitStream_write(stream, use_delta ? 1 : 0, 8);
+
+    // Serialize the code lengths into the bitstream
+    WideSymbol_serialize(stream, symbols, num_used);
+
+    // Encode the input file sample by sample
+    for (i = 0; i < num_samples; i++) {
+        WideSymbol* curr = WideSymbol_find(symbols, num_used, samples[i]);
+        BitStream_write(stream, curr->encoded.encoded_symbol, curr->encoded.encoded_len);
+    }
+
+    // Cleanup
+    free(samples);
+    free(symbols);
+    free(in_stream.data);
+
+    // Save the bitstream to an output file
+    printf("Successfully encoded the file with %d distinct 16-bit symbols%s\n", num_used, use_delta ? " (delta)" : "");
+    BitStream_save(stream, "encoded.bin");
+
+}
+
+void decode_wide(BitStream* stream, BitStream* out_stream, uint32_t num_bytes) {
+
+    // Read the mode flags and rebuild the canonical code from the serialized lengths
+    int use_delta = BitStream_read(stream, 8) & 0x01;
+    WideSymbol* symbols = malloc(65536 * sizeof(WideSymbol));
+    int num_used = WideSymbol_deserialize(stream, symbols);
+    WideDecoder decoder;
+    WideDecoder_init(&decoder, symbols, num_used);
+
+    // Decode the samples using the lookup table
+    int num_samples = num_bytes / 2 + num_bytes % 2;
+    uint16_t* samples = malloc((num_samples ? num_samples : 1) * sizeof(uint16_t));
+    int i;
+    for (i = 0; i < num_samples; i++) {
+        samples[i] = WideDecoder_read(&decoder, stream);
+    }
+    if (use_delta) {
+        WideSamples_undelta(samples, num_samples);
+    }
+
+    // Write the samples back out as little-endian bytes, dropping the padding byte of an odd length file
+    BitStream_init_empty(out_stream, 1048576);
+    for (i = 0; i < num_samples; i++) {
+        BitStream_write(out_stream, samples[i] & 0xFF, 8);
+        BitStream_write(out_stream, samples[i] >> 8, 8);
+    }
+    out_stream->position = num_bytes * 8;
+
+    // Cleanup
+    WideDecoder_free(&decoder);
+    free(symbols);
+    free(samples);
+
+}
+
 void decode_file(char* filepath, int decode_levels) {
 
     // Load the input file to a new bitstream
     BitStream* stream = malloc(sizeof(BitStream));
-    BitStream_init_empty(stream, 1048576);
+    BitStream_init_empty(stream, 2097152);
     BitStream_load(stream, "encoded.bin");
     stream->position = 0;
 
@@ -382,14 +489,19 @@ void decode_file(char* filepath, int decode_levels) {
         }
         // printf("DECODED LENGTH: %d\n", num_chars);
 
-        // Deserialize the huffman tree from the encoded file's bitstream
-        HuffmanNode* head = calloc(sizeof(HuffmanNode), 1);
-        deserialize_tree(stream, head);
-
-        // Decode the file symbol by symbol and save to the output file
-        BitStream_init_empty(&out_stream, 1048576);
-        for (i = 0; i < num_chars; i++) {
-            BitStream_write(&out_stream, get_symbol(stream, head), 8);
+        if (fcode[4] == '2') {
+            // Wide symbol mode, decode 16-bit samples
+            decode_wide(stream, &out_stream, num_chars);
+        } else {
+            // Deserialize the huffman tree from the encoded file's bitstream
+            HuffmanNode* head = calloc(sizeof(HuffmanNode), 1);
+            deserialize_tree(stream, head);
+
+            // Decode the file symbol by symbol and save to the output file
+            BitStream_init_empty(&out_stream, 1048576);
+            for (i = 0; i < num_chars; i++) {
+                BitStream_write(&out_stream, get_symbol(stream, head), 8);
+            }
         }
 
         // Check if we should keep decoding
@@ -423,6 +535,7 @@ int main(int argc, char** argv) {
     char* fname;
     int mode = 0; // 0 for auto, 1 for encode, 2 for decode, 3 for debug
     int level = 0; // 0 for auto-detect encoding/decoding level
+    int wide = 0; // 0 for byte symbols, 1 for 16-bit symbols, 2 for 16-bit symbols after delta
     int i;
     for (i = 1; i < argc; i++) {
         char* curr = argv[i];
@@ -433,6 +546,10 @@ int main(int argc, char** argv) {
                 mode = 2;
             } else if (!strcmp(curr, "-z")) {
                 mode = 3;
+            } else if (!strcmp(curr, "-w")) {
+                wide = 1;
+            } else if (!strcmp(curr, "-wd")) {
+                wide = 2;
             } else if (curr[1] == 'l') {
                 level = atoi(curr + 2);
             }
@@ -460,11 +577,19 @@ int main(int argc, char** argv) {
 
     // Run the encoder/decoder
     if (mode == 1) {
-        encode_file(fname, level);
+        if (wide) {
+            encode_file_wide(fname, wide == 2);
+        } else {
+            encode_file(fname, level);
+        }
     } else if (mode == 2) {
         decode_file(fname, level);
     } else if (mode == 3) {
-        encode_file(fname, level);
+        if (wide) {
+            encode_file_wide(fname, wide == 2);
+        } else {
+            encode_file(fname, level);
+        }
         printf("----------------------\n");
         decode_file("encoded.bin", level);
     }
@@ -1,4 +1,4 @@
-#include "encode_utils.h"
+#include "wide_utils.h"
 
 struct HuffmanNode {
     struct HuffmanNode* left;
@@ -0,0 +1,302 @@
+#include "wide_utils.h"
+
+void WideSamples_load(uint16_t* samples, uint8_t* data, int num_bytes) {
+    int i;
+    for (i = 0; i < num_bytes / 2; i++) {
+        samples[i] = data[2 * i] | (data[2 * i + 1] << 8);
+    }
+    if (num_bytes % 2) {
+        // Odd trailing byte is padded with a zero high byte
+        samples[i] = data[2 * i];
+    }
+}
+
+void WideSamples_delta(uint16_t* samples, int num_samples) {
+    int i;
+    for (i = num_samples - 1; i > 0; i--) {
+        samples[i] -= samples[i - 1];
+    }
+}
+
+void WideSamples_undelta(uint16_t* samples, int num_samples) {
+    int i;
+    for (i = 1; i < num_samples; i++) {
+        samples[i] += samples[i - 1];
+    }
+}
+
+int WideSymbol_histogram(WideSymbol* symbols, uint16_t* samples, int num_samples) {
+
+    // Radix sort a copy of the samples (low byte, then high byte) so only the used symbols are ever counted
+    uint16_t* sorted = malloc(num_samples * sizeof(uint16_t));
+    uint16_t* scratch = malloc(num_samples * sizeof(uint16_t));
+    memcpy(sorted, samples, num_samples * sizeof(uint16_t));
+    int shift;
+    int i;
+    for (shift = 0; shift < 16; shift += 8) {
+        int offsets[256] = {0};
+        for (i = 0; i < num_samples; i++) {
+            offsets[(sorted[i] >> shift) & 0xFF]++;
+        }
+        int total = 0;
+        for (i = 0; i < 256; i++) {
+            int count = offsets[i];
+            offsets[i] = total;
+            total += count;
+        }
+        for (i = 0; i < num_samples; i++) {
+            scratch[offsets[(sorted[i] >> shift) & 0xFF]++] = sorted[i];
+        }
+        uint16_t* temp = sorted;
+        sorted = scratch;
+        scratch = temp;
+    }
+
+    // Collapse runs of equal samples into (symbol, count) pairs, in ascending symbol order
+    int num_symbols = 0;
+    for (i = 0; i < num_samples; i++) {
+        if (num_symbols == 0 || symbols[num_symbols - 1].encoded.raw_symbol != sorted[i]) {
+            EncodedChar_init(&(symbols[num_symbols].encoded), sorted[i], 0, 0);
+            symbols[num_symbols].count = 0;
+            num_symbols++;
+        }
+        symbols[num_symbols - 1].count++;
+    }
+
+    free(sorted);
+    free(scratch);
+    return num_symbols;
+}
+
+int compare_symbol_counts(const void* a, const void* b) {
+    WideSymbol* sa = *(WideSymbol**)a;
+    WideSymbol* sb = *(WideSymbol**)b;
+    if (sa->count != sb->count) {
+        return sa->count < sb->count ? -1 : 1;
+    }
+    return (int)sa->encoded.raw_symbol - (int)sb->encoded.raw_symbol;
+}
+
+void WideSymbol_build_lengths(WideSymbol* symbols, int num_symbols) {
+    if (num_symbols == 0) {
+        return;
+    }
+    if (num_symbols == 1) {
+        symbols[0].encoded.encoded_len = 1;
+        return;
+    }
+
+    // Order the symbols from least to most frequent
+    WideSymbol** by_count = malloc(num_symbols * sizeof(WideSymbol*));
+    uint32_t* lengths = malloc(num_symbols * sizeof(uint32_t));
+    int i;
+    for (i = 0; i < num_symbols; i++) {
+        by_count[i] = &symbols[i];
+    }
+    qsort(by_count, num_symbols, sizeof(WideSymbol*), compare_symbol_counts);
+    for (i = 0; i < num_symbols; i++) {
+        lengths[i] = by_count[i]->count;
+    }
+
+    // Compute unrestricted huffman code lengths in place (Moffat & Katajainen), no tree nodes needed
+    int root = 0;
+    int leaf = 2;
+    int next;
+    lengths[0] += lengths[1];
+    for (next = 1; next < num_symbols - 1; next++) {
+        if (leaf >= num_symbols || lengths[root] < lengths[leaf]) {
+            lengths[next] = lengths[root];
+            lengths[root++] = next;
+        } else {
+            lengths[next] = lengths[leaf++];
+        }
+        if (leaf >= num_symbols || (root < next && lengths[root] < lengths[leaf])) {
+            lengths[next] += lengths[root];
+            lengths[root++] = next;
+        } else {
+            lengths[next] += lengths[leaf++];
+        }
+    }
+    lengths[num_symbols - 2] = 0;
+    for (next = num_symbols - 3; next >= 0; next--) {
+        lengths[next] = lengths[lengths[next]] + 1;
+    }
+    int available = 1;
+    int used = 0;
+    int depth = 0;
+    root = num_symbols - 2;
+    next = num_symbols - 1;
+    while (available > 0) {
+        while (root >= 0 && lengths[root] == depth) {
+            used++;
+            root--;
+        }
+        while (available > used) {
+            lengths[next--] = depth;
+            available--;
+        }
+        available = 2 * used;
+        depth++;
+        used = 0;
+    }
+
+    // Clamp to the maximum code length, then push codes down until the kraft sum fits again
+    int length_counts[WIDE_MAX_CODE_LEN + 1] = {0};
+    for (i = 0; i < num_symbols; i++) {
+        length_counts[lengths[i] > WIDE_MAX_CODE_LEN ? WIDE_MAX_CODE_LEN : lengths[i]]++;
+    }
+    uint32_t kraft_total = 0;
+    for (i = 1; i <= WIDE_MAX_CODE_LEN; i++) {
+        kraft_total += (uint32_t)length_counts[i] << (WIDE_MAX_CODE_LEN - i);
+    }
+    while (kraft_total != (1u << WIDE_MAX_CODE_LEN)) {
+        length_counts[WIDE_MAX_CODE_LEN]--;
+        for (i = WIDE_MAX_CODE_LEN - 1; i > 0; i--) {
+            if (length_counts[i]) {
+                length_counts[i]--;
+                length_counts[i + 1] += 2;
+                break;
+            }
+        }
+        kraft_total--;
+    }
+
+    // Hand out the lengths longest first, so the least frequent symbols get the longest codes
+    next = 0;
+    for (depth = WIDE_MAX_CODE_LEN; depth > 0; depth--) {
+        for (i = 0; i < length_counts[depth]; i++) {
+            by_count[next++]->encoded.encoded_len = depth;
+        }
+    }
+
+    free(by_count);
+    free(lengths);
+}
+
+void WideSymbol_assign_codes(WideSymbol* symbols, int num_symbols) {
+    int length_counts[WIDE_MAX_CODE_LEN + 1] = {0};
+    uint32_t next_code[WIDE_MAX_CODE_LEN + 1];
+    int i;
+    for (i = 0; i < num_symbols; i++) {
+        length_counts[symbols[i].encoded.encoded_len]++;
+    }
+    length_counts[0] = 0;
+
+    // Canonical codes: consecutive within a length, in ascending symbol order
+    uint32_t code = 0;
+    for (i = 1; i <= WIDE_MAX_CODE_LEN; i++) {
+        code = (code + length_counts[i - 1]) << 1;
+        next_code[i] = code;
+    }
+    for (i = 0; i < num_symbols; i++) {
+        int length = symbols[i].encoded.encoded_len;
+        symbols[i].encoded.encoded_symbol = next_code[length]++;
+    }
+}
+
+WideSymbol* WideSymbol_find(WideSymbol* symbols, int num_symbols, uint16_t symbol) {
+    int low = 0;
+    int high = num_symbols - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        uint16_t curr = symbols[mid].encoded.raw_symbol;
+        if (curr == symbol) {
+            return &symbols[mid];
+        } else if (curr < symbol) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return NULL;
+}
+
+void WideSymbol_serialize(BitStream* stream, WideSymbol* symbols, int num_symbols) {
+    // Only the code lengths are stored, the decoder rebuilds the canonical codes from them
+    BitStream_write(stream, num_symbols, 17);
+    int i;
+    for (i = 0; i < num_symbols; i++) {
+        BitStream_write(stream, symbols[i].encoded.raw_symbol, 16);
+        BitStream_write(stream, symbols[i].encoded.encoded_len, 5);
+    }
+}
+
+int WideSymbol_deserialize(BitStream* stream, WideSymbol* symbols) {
+    int num_symbols = BitStream_read(stream, 17);
+    int i;
+    for (i = 0; i < num_symbols; i++) {
+        uint16_t symbol = BitStream_read(stream, 16);
+        int length = BitStream_read(stream, 5);
+        EncodedChar_init(&(symbols[i].encoded), symbol, length, 0);
+        symbols[i].count = 0;
+    }
+    WideSymbol_assign_codes(symbols, num_symbols);
+    return num_symbols;
+}
+
+void WideDecoder_init(WideDecoder* decoder, WideSymbol* symbols, int num_symbols) {
+    decoder->fast_symbol = calloc(1 << WIDE_FAST_BITS, sizeof(uint16_t));
+    decoder->fast_length = calloc(1 << WIDE_FAST_BITS, sizeof(uint8_t));
+    decoder->sorted_symbols = malloc((num_symbols ? num_symbols : 1) * sizeof(uint16_t));
+    memset(decoder->length_counts, 0, sizeof(decoder->length_counts));
+
+    int i;
+    for (i = 0; i < num_symbols; i++) {
+        decoder->length_counts[symbols[i].encoded.encoded_len]++;
+    }
+
+    // Symbols ordered by (length, symbol) for the slow path, which walks the canonical code one bit at a time
+    int offsets[WIDE_MAX_CODE_LEN + 1];
+    offsets[1] = 0;
+    for (i = 1; i < WIDE_MAX_CODE_LEN; i++) {
+        offsets[i + 1] = offsets[i] + decoder->length_counts[i];
+    }
+    for (i = 0; i < num_symbols; i++) {
+        decoder->sorted_symbols[offsets[symbols[i].encoded.encoded_len]++] = symbols[i].encoded.raw_symbol;
+    }
+
+    // Short codes get every fast table slot that starts with them, longer codes are left at length 0
+    for (i = 0; i < num_symbols; i++) {
+        int length = symbols[i].encoded.encoded_len;
+        if (length <= WIDE_FAST_BITS) {
+            int first = symbols[i].encoded.encoded_symbol << (WIDE_FAST_BITS - length);
+            int last = first + (1 << (WIDE_FAST_BITS - length));
+            int j;
+            for (j = first; j < last; j++) {
+                decoder->fast_symbol[j] = symbols[i].encoded.raw_symbol;
+                decoder->fast_length[j] = length;
+            }
+        }
+    }
+}
+
+uint16_t WideDecoder_read(WideDecoder* decoder, BitStream* stream) {
+    uint32_t index = BitStream_peek(stream, WIDE_FAST_BITS);
+    if (decoder->fast_length[index]) {
+        stream->position += decoder->fast_length[index];
+        return decoder->fast_symbol[index];
+    }
+
+    // Slow path for codes longer than the fast table
+    int code = 0;
+    int first = 0;
+    int offset = 0;
+    int length;
+    for (length = 1; length <= WIDE_MAX_CODE_LEN; length++) {
+        code |= BitStream_read(stream, 1);
+        int count = decoder->length_counts[length];
+        if (code - count < first) {
+            return decoder->sorted_symbols[offset + (code - first)];
+        }
+        offset += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return 0;
+}
+
+void WideDecoder_free(WideDecoder* decoder) {
+    free(decoder->fast_symbol);
+    free(decoder->fast_length);
+    free(decoder->sorted_symbols);
+}
@@ -0,0 +1,32 @@
+#include "encode_utils.h"
+
+#define WIDE_MAX_CODE_LEN 20
+#define WIDE_FAST_BITS 10
+
+struct WideSymbol {
+    EncodedChar encoded;
+    uint32_t count;
+};
+
+struct WideDecoder {
+    uint16_t* fast_symbol;
+    uint8_t* fast_length;
+    int length_counts[WIDE_MAX_CODE_LEN + 1];
+    uint16_t* sorted_symbols;
+};
+
+typedef struct WideSymbol WideSymbol;
+typedef struct WideDecoder WideDecoder;
+
+void WideSamples_load(uint16_t* samples, uint8_t* data, int num_bytes);
+void WideSamples_delta(uint16_t* samples, int num_samples);
+void WideSamples_undelta(uint16_t* samples, int num_samples);
+int WideSymbol_histogram(WideSymbol* symbols, uint16_t* samples, int num_samples);
+void WideSymbol_build_lengths(WideSymbol* symbols, int num_symbols);
+void WideSymbol_assign_codes(WideSymbol* symbols, int num_symbols);
+WideSymbol* WideSymbol_find(WideSymbol* symbols, int num_symbols, uint16_t symbol);
+void WideSymbol_serialize(BitStream* stream, WideSymbol* symbols, int num_symbols);
+int WideSymbol_deserialize(BitStream* stream, WideSymbol* symbols);
+void WideDecoder_init(WideDecoder* decoder, WideSymbol* symbols, int num_symbols);
+uint16_t WideDecoder_read(WideDecoder* decoder, BitStream* stream);
+void WideDecoder_free(WideDecoder* decoder);